@@ -7,30 +7,66 @@
 
 #include "c_array.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 void* _arrayCreate(const size_t capacity, const size_t increment, const size_t stride)
 {
-	const size_t header = ARRAY * sizeof(size_t);
-	const size_t size = capacity * stride;
-	size_t* array = (size_t*) malloc(header + size);
-	if (array == NULL)
+	return _arrayAdopt(_arrayBufferAlloc(capacity * stride), 0, capacity, increment, stride);
+}
+
+void arrayDestroy(void* array)
+{
+	void* previous = (void*) (uintptr_t) _arrayFieldGet(array, PREVIOUS);
+	if (previous)
+		arrayDestroy(previous);
+	free((char*) array - ARRAY_HEADER_SIZE);
+}
+
+void* _arrayBufferAlloc(const size_t size)
+{
+	char* buffer = (char*) malloc(ARRAY_HEADER_SIZE + size);
+	if (buffer == NULL)
 	{
 		fprintf(stderr, "Memory allocation failed\n");
-		free(array);
 		exit(EXIT_FAILURE);
 	}
-	array[LENGTH] = 0;
+	return (void*) (buffer + ARRAY_HEADER_SIZE);
+}
+
+void arrayBufferFree(void* buffer)
+{
+	free((char*) buffer - ARRAY_HEADER_SIZE);
+}
+
+void* _arrayAdopt(void* buffer, const size_t length, const size_t capacity, const size_t increment, const size_t stride)
+{
+	// Header space was reserved by '_arrayBufferAlloc', only the fields need writing
+	size_t* array = (size_t*) buffer - ARRAY;
+	array[LENGTH] = length;
 	array[CAPACITY] = capacity;
 	array[INCREMENT] = increment;
 	array[STRIDE] = stride;
-	return (void*) (array + ARRAY);
+	array[STEP] = 0;
+	array[PREVIOUS] = 0;
+	array[MIGRATED] = 0;
+	return buffer;
 }
 
-void arrayDestroy(void* array)
+void* arrayRelease(void* array, size_t* length)
 {
-	free(array - ARRAY * sizeof(size_t));
+	// The payload stays where it is, the caller owns it from now on & frees it with 'arrayBufferFree'
+	arrayMigrateFinish(array);
+	if (length)
+		*length = arrayGetLength(array);
+	return array;
+}
+
+ArraySlice arraySliceOf(const void* data, const size_t length, const size_t stride)
+{
+	const ArraySlice slice = { data, length, stride };
+	return slice;
 }
 
 size_t _arrayFieldGet(void* array, const size_t field)
@@ -45,20 +81,83 @@ void _arrayFieldSet(void* array, const size_t field, const size_t value)
 
 void* _arrayResize(void* array, const size_t capacity)
 {
+	arrayMigrateFinish(array);
+
 	const size_t length = arrayGetLength(array);
 	const size_t stride = arrayGetStride(array);
+	const size_t step = arrayGetMigrationStep(array);
 
 	void* newArray = _arrayCreate(
 		capacity,
 		arrayGetIncrement(array),
 		stride
 		);
-	memcpy(newArray, array, length * stride);
 	_arrayFieldSet(newArray, LENGTH, length);
+	_arrayFieldSet(newArray, STEP, step);
+	// Incremental growth, leave the elements in the old block for the following pushes to move
+	// Shrinking (e.g. 'arrayCapacityDeflate') has no pushes coming to finish the work, so it copies straight away
+	if (step && length && capacity > arrayGetCapacity(array))
+	{
+		if (length > step * (capacity - length))
+			fprintf(stderr, "Incremental resize can't keep to %zu elements per push, %zu elements over %zu pushes! Raise the increment!\n",
+				step,
+				length,
+				capacity - length);
+		_arrayFieldSet(newArray, PREVIOUS, (size_t) (uintptr_t) array);
+		return newArray;
+	}
+	memcpy(newArray, array, length * stride);
 	arrayDestroy(array);
 	return newArray;
 }
 
+int _arraySetMigrationStep(void* array, const size_t step)
+{
+	// The next resize moves 'capacity' elements over 'increment' pushes
+	if (step && step * arrayGetIncrement(array) < arrayGetCapacity(array))
+	{
+		fprintf(stderr, "Migration step %zu is too small for capacity %zu with increment %zu! Raise the step or increment!\n",
+			step,
+			arrayGetCapacity(array),
+			arrayGetIncrement(array));
+		return 0;
+	}
+	_arrayFieldSet(array, STEP, step);
+	return 1;
+}
+
+void* _arrayAt(void* array, const size_t index)
+{
+	char* previous = (char*) (uintptr_t) _arrayFieldGet(array, PREVIOUS);
+	const size_t stride = arrayGetStride(array);
+	if (previous && index >= _arrayFieldGet(array, MIGRATED) && index < arrayGetLength(previous))
+		return previous + index * stride;
+	return (char*) array + index * stride;
+}
+
+void _arrayMigrate(void* array, size_t count)
+{
+	char* previous = (char*) (uintptr_t) _arrayFieldGet(array, PREVIOUS);
+	if (!previous)
+		return;
+
+	const size_t stride = arrayGetStride(array);
+	const size_t migrated = _arrayFieldGet(array, MIGRATED);
+	const size_t remaining = arrayGetLength(previous) - migrated;
+	if (count > remaining)
+		count = remaining;
+
+	memcpy((char*) array + migrated * stride, previous + migrated * stride, count * stride);
+	if (count == remaining)
+	{
+		arrayDestroy(previous);
+		_arrayFieldSet(array, PREVIOUS, 0);
+		_arrayFieldSet(array, MIGRATED, 0);
+	}
+	else
+		_arrayFieldSet(array, MIGRATED, migrated + count);
+}
+
 // void* _arrayPush(void* array, const void* element)
 // {
 // 	const size_t length = arrayGetLength(array);
@@ -96,6 +195,22 @@ void* _arrayPushAt(void* array, const size_t index, const void* element)
 	if (length >= arrayGetCapacity(array))
 		arrayCapacityIncrement(array);
 
+	if (arrayIsMigrating(array))
+	{
+		if (index < length)
+			arrayMigrateFinish(array);
+		else
+		{
+			// Move enough that the old block is empty by the time this one is full
+			const size_t pushesLeft = arrayGetCapacity(array) - length;
+			const size_t left = arrayGetLength((void*) (uintptr_t) _arrayFieldGet(array, PREVIOUS)) - _arrayFieldGet(array, MIGRATED);
+			size_t count = arrayGetMigrationStep(array);
+			if (left > count * pushesLeft)
+				count = (left + pushesLeft - 1) / pushesLeft;
+			_arrayMigrate(array, count);
+		}
+	}
+
 	const size_t offset = index * stride;
 	// Shift array from index right by 1
 	if (index < length)
@@ -134,6 +249,24 @@ void _arrayPopAt(void* array, const size_t index, void* dest)
 	const size_t length = arrayGetLength(array);
 	const size_t stride = arrayGetStride(array);
 
+	// Popping the back can read straight from the old block, anything else needs the elements in place to shift
+	if (arrayIsMigrating(array))
+	{
+		if (index < length - 1)
+			arrayMigrateFinish(array);
+		else
+		{
+			if (dest)
+				memcpy(dest, _arrayAt(array, index), stride);
+			void* previous = (void*) (uintptr_t) _arrayFieldGet(array, PREVIOUS);
+			if (arrayGetLength(previous) > index)
+				_arrayFieldSet(previous, LENGTH, index);
+			_arrayFieldSet(array, LENGTH, length - 1);
+			_arrayMigrate(array, 0);
+			return;
+		}
+	}
+
 	const size_t offset = index * stride;
 	// Copy element to dest
 	if (dest)
@@ -143,3 +276,34 @@ void _arrayPopAt(void* array, const size_t index, void* dest)
 		memcpy(array + offset, array + (index + 1) * stride, (length - index - 1) * stride);
 	_arrayFieldSet(array, LENGTH, length - 1);
 }
+
+void* _arrayPushSlice(void* array, ArraySlice slice)
+{
+	arrayMigrateFinish(array);
+
+	const size_t length = arrayGetLength(array);
+	const size_t stride = arrayGetStride(array);
+
+	// Grow once to fit the whole slice
+	if (length + slice.length > arrayGetCapacity(array))
+	{
+		const size_t increment = arrayGetIncrement(array);
+		const size_t needed = length + slice.length;
+		// A slice of the array itself has to follow it to the new block
+		const char* begin = (const char*) array;
+		const char* data = (const char*) slice.data;
+		const int inside = data >= begin && data < begin + length * stride;
+		array = _arrayResize(array, needed - 1 - ((needed - 1) % increment) + increment);
+		if (inside)
+			slice.data = (const char*) array + (data - begin);
+	}
+
+	char* dest = (char*) array + length * stride;
+	if (slice.stride == stride)
+		memcpy(dest, slice.data, slice.length * stride);
+	else
+		for (size_t i = 0; i < slice.length; i++)
+			memcpy(dest + i * stride, arraySliceAt(slice, i), stride);
+	_arrayFieldSet(array, LENGTH, length + slice.length);
+	return array;
+}
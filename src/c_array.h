@@ -10,11 +10,22 @@
  * 17/11/2025
  * Changelog 1.1:
  *	- Added arrayPushBack & arrayPopBack for clarity
+ *
+ * 19/10/2026
+ * Changelog 1.2:
+ *	- Added arrayBufferAlloc & arrayAdopt to take over a buffer without copying
+ *	- Added arrayRelease to hand the payload back as a plain pointer
+ *	- Added ArraySlice, a non-owning (pointer, length, stride) view & arrayPushSlice
+ *
+ * Changelog 1.3:
+ *	- Added incremental resize, see arraySetMigrationStep
+ *	- Header is padded to ARRAY_HEADER_SIZE so payloads stay aligned for any type
  */
 
 #ifndef ARRAY_NEW_H
 #define ARRAY_NEW_H
 
+#include <stddef.h>
 #include <stdlib.h>
 
 // struct array
@@ -23,6 +34,9 @@
 // 	size_t capacity;
 // 	size_t increment;
 //	size_t stride;
+//	size_t step;
+//	void* previous;
+//	size_t migrated;
 // 	void* array;
 // };
 
@@ -32,17 +46,45 @@ enum ArrayFields
 	CAPACITY,
 	INCREMENT,
 	STRIDE,
+	STEP,		// Elements migrated per push after a resize, 0 copies everything on resize
+	PREVIOUS,	// Block still being migrated from, its length is the number of elements it holds
+	MIGRATED,	// Elements already copied out of 'PREVIOUS'
 	ARRAY
 };
 
+// Bytes in front of the payload, the fields sit right before it & the size is rounded up so the payload keeps malloc's alignment
+#define ARRAY_HEADER_SIZE ((ARRAY * sizeof(size_t) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+// Non-owning view of 'length' elements 'stride' bytes apart, never freed through the view
+typedef struct ArraySlice
+{
+	const void* data;
+	size_t length;
+	size_t stride;
+} ArraySlice;
+
 void* _arrayCreate(size_t capacity, size_t increment, size_t stride);
 void arrayDestroy(void* array);
 
+// Allocates 'size' bytes with room for the array header in front, fill it then pass it to 'arrayAdopt'
+void* _arrayBufferAlloc(size_t size);
+void arrayBufferFree(void* buffer);
+void* _arrayAdopt(void* buffer, size_t length, size_t capacity, size_t increment, size_t stride);
+void* arrayRelease(void* array, size_t* length);
+
+ArraySlice arraySliceOf(const void* data, size_t length, size_t stride);
+
 size_t _arrayFieldGet(void* array, size_t field);
 void _arrayFieldSet(void* array, size_t field, size_t value);
 
 void* _arrayResize(void* array, size_t capacity);
 
+// Incremental resize, while 'arrayIsMigrating' use 'arrayAt' / 'arrayGet' instead of indexing the array directly
+// Refuses (returns 0 & leaves the step as is) when the next resize couldn't keep to 'step' elements per push
+int _arraySetMigrationStep(void* array, size_t step);
+void* _arrayAt(void* array, size_t index);
+void _arrayMigrate(void* array, size_t count);
+
 // void* _arrayPush(void* array, const void* element);
 // void* _arrayPushFront(void* array, const void* element);
 void* _arrayPushAt(void* array, size_t index, const void* element);
@@ -51,6 +93,8 @@ void* _arrayPushAt(void* array, size_t index, const void* element);
 // void arrayPopFront(void* array, void* dest);
 void _arrayPopAt(void* array, size_t index, void* dest);
 
+void* _arrayPushSlice(void* array, ArraySlice slice);
+
 #define arrayCreate(type) _arrayCreate(2, 2, sizeof(type))
 #define arrayCreatePrealloc(type, capacity, increment) _arrayCreate(capacity, increment, sizeof(type))
 
@@ -58,6 +102,17 @@ void _arrayPopAt(void* array, size_t index, void* dest);
 #define arrayGetCapacity(array) _arrayFieldGet(array, CAPACITY)
 #define arrayGetIncrement(array) _arrayFieldGet(array, INCREMENT)
 #define arrayGetStride(array) _arrayFieldGet(array, STRIDE)
+#define arrayGetMigrationStep(array) _arrayFieldGet(array, STEP)
+
+// With a step set, growing allocates the new block & the old elements are moved 'step' at a time by each push back
+// A resize leaves 'increment' pushes to move 'length' elements, so the per-push bound only holds while 'length <= step * increment'
+// Past that each push moves about 'length / increment' elements so migration still finishes before the new block fills up,
+// & the resize prints a warning. With linear growth pick 'increment' for the largest length you expect, e.g. not the default 2
+#define arraySetMigrationStep(array, step) _arraySetMigrationStep(array, step)
+#define arrayIsMigrating(array) (_arrayFieldGet(array, PREVIOUS) != 0)
+#define arrayMigrateFinish(array) _arrayMigrate(array, (size_t) -1)
+#define arrayAt(array, index) _arrayAt(array, index)
+#define arrayGet(type, array, index) (*(type*) _arrayAt(array, index))
 
 #define arrayCapacityIncrement(array) (array = _arrayResize(array, _arrayFieldGet(array, CAPACITY) + _arrayFieldGet(array, INCREMENT)))
 #define arrayCapacityDeflate(array) \
@@ -79,4 +134,16 @@ void _arrayPopAt(void* array, size_t index, void* dest);
 #define arrayPopFront(array, dest) _arrayPopAt(array, 0, &dest)
 #define arrayPopAt(array, index, element) _arrayPopAt(array, index, &element)
 
+#define arrayBufferAlloc(type, capacity) ((type*) _arrayBufferAlloc((capacity) * sizeof(type)))
+#define arrayAdopt(type, buffer, length, capacity) _arrayAdopt(buffer, length, capacity, 2, sizeof(type))
+
+// Slicing a migrating array finishes the migration first, slices read the payload directly
+#define arraySlice(array, start, length) (arrayMigrateFinish(array), arraySliceOf((const char*) (array) + (start) * arrayGetStride(array), length, arrayGetStride(array)))
+#define arraySliceAll(array) (arrayMigrateFinish(array), arraySliceOf(array, arrayGetLength(array), arrayGetStride(array)))
+#define arraySliceField(array, field) (arrayMigrateFinish(array), arraySliceOf(&(array)->field, arrayGetLength(array), arrayGetStride(array)))
+#define arraySliceAt(slice, index) ((const void*) ((const char*) (slice).data + (index) * (slice).stride))
+#define arraySliceGet(type, slice, index) (*(const type*) arraySliceAt(slice, index))
+
+#define arrayPushSlice(array, slice) (array = _arrayPushSlice(array, slice))
+
 #endif //ARRAY_NEW_H
@@ -3,7 +3,17 @@
  * If you want to define a new array type put 'ARRAY_H_DEFINE_ARRAY(TYPE_HERE)'
  * e.g. ARRAY_H_DEFINE_ARRAY(car_t) // 'car_t' would be a struct
  *
- * Version: 2.2
+ * If you want a bit-packed array put 'ARRAY_H_DEFINE_PACKED(NAME, BITS)' or 'ARRAY_H_DEFINE_BITARRAY(NAME)'
+ * e.g. ARRAY_H_DEFINE_PACKED(u4, 4) // 'array_u4_t' holding 4-bit unsigned values
+ *
+ * If you want O(1) lookup by key put 'ARRAY_H_DEFINE_INDEX(TYPE, KEY_TYPE, KEY_FIELD, HASH)' after 'ARRAY_H_DEFINE_ARRAY(TYPE)'
+ * e.g. ARRAY_H_DEFINE_INDEX(car_t, int, id, car_id_hash) // 'array_car_t_id_index_t'
+ *
+ * If you want a priority queue put 'ARRAY_H_DEFINE_HEAP(TYPE, LESS)' after 'ARRAY_H_DEFINE_ARRAY(TYPE)'
+ * e.g. ARRAY_H_DEFINE_HEAP(timer_t, timer_less) // 'array_timer_t_heap_t'
+ * or ARRAY_H_DEFINE_HEAP_ARITY(timer_t, timer_less, 4) // 'array_timer_t_heap4_t'
+ *
+ * Version: 2.5
  * Created by Duncan (CoffeeCatRailway) on 01/04/2025.
  * Original: https://gist.github.com/CoffeeCatRailway/c55f8f56aaf40e2ecd5c3c6994370289
  *
@@ -47,15 +57,33 @@
  * Changelog 2.2:
  *	- Method declarations
  *	- Methods that alter array values and/or capacity now take array pointer pointer
+ *
+ * 19/10/2026
+ * Changelog 2.3:
+ *	- Added 'ARRAY_H_DEFINE_PACKED', n-bit (1-32) unsigned elements packed into 64-bit words
+ *	- Added 'ARRAY_H_DEFINE_BITARRAY', 1-bit packed array with popcount, find first set/clear & bulk and/or/xor/andnot
+ *
+ * Changelog 2.4:
+ *	- Added 'array_type_swap_remove', moves the last element into the removed slot instead of shifting
+ *	- Added 'ARRAY_H_DEFINE_INDEX', open addressing hash index from key to element position
+ *
+ * Changelog 2.5:
+ *	- Added 'ARRAY_H_DEFINE_HEAP' & 'ARRAY_H_DEFINE_HEAP_ARITY', d-ary min heap with handles for decrease key
  */
 
 #ifndef ARRAY_H_
 #define ARRAY_H_
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ARRAY_H_INDEX_SSE2
+#include <emmintrin.h>
+#endif
+
 #define ARRAY_H_DEFINE_ARRAY(type) \
 	typedef struct array_##type##_t \
 	{ \
@@ -69,6 +97,7 @@
 	static void array_##type##_delete(array_##type##_t* array); \
 	static void array_##type##_push(array_##type##_t** array, type element); \
 	static type array_##type##_remove_at(array_##type##_t** array, size_t i); \
+	static type array_##type##_swap_remove(array_##type##_t** array, size_t i); \
 	static void array_##type##_adjust(array_##type##_t** array); \
 	\
 	static array_##type##_t* array_##type##_create(const size_t capacity) \
@@ -126,6 +155,15 @@
 		return value; \
 	} \
 	\
+	static type array_##type##_swap_remove(array_##type##_t** array, const size_t i) \
+	{ \
+		const type value = (*array)->array[i]; \
+		(*array)->size--; \
+		if (i < (*array)->size) \
+			(*array)->array[i] = (*array)->array[(*array)->size]; \
+		return value; \
+	} \
+	\
 	static void array_##type##_adjust(array_##type##_t** array) \
 	{ \
 		const size_t capacityAdjusted = (*array)->size - 1 - (((*array)->size - 1) % (*array)->capacityIncrement) + (*array)->capacityIncrement; \
@@ -145,6 +183,707 @@
 		} \
 	}
 
+// Word helpers shared by all packed arrays
+// Bits past 'size' are always kept zero, word operations rely on this
+
+#define ARRAY_H_WORD_BITS 64
+#define ARRAY_H_WORDS(bits) (((bits) + ARRAY_H_WORD_BITS - 1) / ARRAY_H_WORD_BITS)
+
+static inline size_t _array_word_popcount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t) __builtin_popcountll(word);
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (size_t) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// 'word' must not be 0
+static inline size_t _array_word_ctz(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t) __builtin_ctzll(word);
+#else
+	size_t n = 0;
+	while (!(word & 1))
+	{
+		word >>= 1;
+		n++;
+	}
+	return n;
+#endif
+}
+
+// Read 64 bits starting at bit 'pos', bits past 'words' read as zero
+static inline uint64_t _array_word_read(const uint64_t* array, const size_t words, const size_t pos)
+{
+	const size_t w = pos / ARRAY_H_WORD_BITS;
+	const size_t o = pos % ARRAY_H_WORD_BITS;
+	if (w >= words)
+		return 0;
+	uint64_t value = array[w] >> o;
+	if (o && w + 1 < words)
+		value |= array[w + 1] << (ARRAY_H_WORD_BITS - o);
+	return value;
+}
+
+// Move every bit from 'pos + shift' onward down to 'pos', 'shift' must be less than 64
+static inline void _array_word_shift_down(uint64_t* array, const size_t words, const size_t pos, const size_t shift)
+{
+	size_t w = pos / ARRAY_H_WORD_BITS;
+	const size_t o = pos % ARRAY_H_WORD_BITS;
+	if (w >= words)
+		return;
+	// Keep bits below 'pos' in the first word
+	const uint64_t keep = o ? (1ULL << o) - 1 : 0;
+	array[w] = (array[w] & keep) | ((_array_word_read(array, words, w * ARRAY_H_WORD_BITS + o + shift) << o) & ~keep);
+	for (w++; w < words; w++)
+		array[w] = _array_word_read(array, words, w * ARRAY_H_WORD_BITS + shift);
+}
+
+// Packed array of 'bits' wide unsigned values, elements may straddle two words
+// 'capacity' & 'capacityIncrement' are counted in elements, not words
+#define ARRAY_H_DEFINE_PACKED(name, bits) \
+	_Static_assert((bits) >= 1 && (bits) <= 32, "Packed array elements must be 1 to 32 bits wide"); \
+	\
+	typedef struct array_##name##_t \
+	{ \
+		size_t size; \
+		size_t capacity; \
+		size_t capacityIncrement; \
+		uint64_t* array; \
+	} array_##name##_t; \
+	\
+	static array_##name##_t* array_##name##_create(size_t capacity); \
+	static void array_##name##_delete(array_##name##_t* array); \
+	static uint32_t array_##name##_get(const array_##name##_t* array, size_t i); \
+	static void array_##name##_set(array_##name##_t* array, size_t i, uint32_t value); \
+	static void array_##name##_push(array_##name##_t** array, uint32_t value); \
+	static uint32_t array_##name##_remove_at(array_##name##_t** array, size_t i); \
+	static void array_##name##_adjust(array_##name##_t** array); \
+	static void _array_##name##_reallocate(array_##name##_t** array, size_t capacity); \
+	\
+	static array_##name##_t* array_##name##_create(const size_t capacity) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(capacity * (bits)); \
+		array_##name##_t* array = malloc(sizeof(array_##name##_t) + words * sizeof(uint64_t)); \
+		if (array == NULL) \
+		{ \
+			fprintf(stderr, "Out of memory! Failed to allocate array!\n"); \
+			exit(EXIT_FAILURE); \
+		} \
+		array->size = 0; \
+		array->capacity = capacity; \
+		array->capacityIncrement = ARRAY_H_WORD_BITS; \
+		array->array = (uint64_t*) (array + 1); \
+		memset(array->array, 0, words * sizeof(uint64_t)); \
+		return array; \
+	} \
+	\
+	static void array_##name##_delete(array_##name##_t* array) \
+	{ \
+		array->array = NULL; \
+		array->size = array->capacity = 0; \
+		free(array); \
+	} \
+	\
+	static uint32_t array_##name##_get(const array_##name##_t* array, const size_t i) \
+	{ \
+		const size_t pos = i * (bits); \
+		const size_t w = pos / ARRAY_H_WORD_BITS; \
+		const size_t o = pos % ARRAY_H_WORD_BITS; \
+		uint64_t value = array->array[w] >> o; \
+		if (o + (bits) > ARRAY_H_WORD_BITS) \
+			value |= array->array[w + 1] << (ARRAY_H_WORD_BITS - o); \
+		return (uint32_t) (value & ((1ULL << (bits)) - 1)); \
+	} \
+	\
+	static void array_##name##_set(array_##name##_t* array, const size_t i, const uint32_t value) \
+	{ \
+		const uint64_t mask = (1ULL << (bits)) - 1; \
+		const uint64_t v = value & mask; \
+		const size_t pos = i * (bits); \
+		const size_t w = pos / ARRAY_H_WORD_BITS; \
+		const size_t o = pos % ARRAY_H_WORD_BITS; \
+		array->array[w] = (array->array[w] & ~(mask << o)) | (v << o); \
+		if (o + (bits) > ARRAY_H_WORD_BITS) \
+		{ \
+			const size_t spill = ARRAY_H_WORD_BITS - o; \
+			array->array[w + 1] = (array->array[w + 1] & ~(mask >> spill)) | (v >> spill); \
+		} \
+	} \
+	\
+	static void _array_##name##_reallocate(array_##name##_t** array, const size_t capacity) \
+	{ \
+		const size_t oldWords = ARRAY_H_WORDS((*array)->capacity * (bits)); \
+		const size_t newWords = ARRAY_H_WORDS(capacity * (bits)); \
+		array_##name##_t* newArray = realloc(*array, sizeof(array_##name##_t) + newWords * sizeof(uint64_t)); \
+		if (newArray == NULL) \
+		{ \
+			fprintf(stderr, "Out of memory! Failed to reallocate array!\n"); \
+			array_##name##_delete(*array); \
+			exit(EXIT_FAILURE); \
+		} \
+		*array = newArray; \
+		(*array)->array = (uint64_t*) (*array + 1); \
+		if (newWords > oldWords) \
+			memset((*array)->array + oldWords, 0, (newWords - oldWords) * sizeof(uint64_t)); \
+		(*array)->capacity = capacity; \
+	} \
+	\
+	static void array_##name##_push(array_##name##_t** array, const uint32_t value) \
+	{ \
+		if ((*array)->size >= (*array)->capacity) \
+			_array_##name##_reallocate(array, (*array)->capacity + (*array)->capacityIncrement); \
+		array_##name##_set(*array, (*array)->size, value); \
+		(*array)->size++; \
+	} \
+	\
+	static uint32_t array_##name##_remove_at(array_##name##_t** array, const size_t i) \
+	{ \
+		const uint32_t value = array_##name##_get(*array, i); \
+		const size_t words = ARRAY_H_WORDS((*array)->size * (bits)); \
+		/* Shifting pulls in the zero bits past 'size', so the freed tail stays zero */ \
+		_array_word_shift_down((*array)->array, words, i * (bits), (bits)); \
+		(*array)->size--; \
+		return value; \
+	} \
+	\
+	static void array_##name##_adjust(array_##name##_t** array) \
+	{ \
+		const size_t increment = (*array)->capacityIncrement; \
+		const size_t capacityAdjusted = (*array)->size == 0 ? increment : (*array)->size - 1 - (((*array)->size - 1) % increment) + increment; \
+		if (capacityAdjusted != (*array)->capacity) \
+			_array_##name##_reallocate(array, capacityAdjusted); \
+	}
+
+// Packed array of single bits, adds word-at-a-time queries & bulk operations to 'ARRAY_H_DEFINE_PACKED(name, 1)'
+// 'find_first_set' & 'find_first_clear' return 'size' when nothing is found
+// Bulk operations only change 'dest' elements, missing 'src' elements count as 0
+#define ARRAY_H_DEFINE_BITARRAY(name) \
+	ARRAY_H_DEFINE_PACKED(name, 1) \
+	\
+	static size_t array_##name##_popcount(const array_##name##_t* array); \
+	static size_t array_##name##_find_first_set(const array_##name##_t* array); \
+	static size_t array_##name##_find_first_clear(const array_##name##_t* array); \
+	static void array_##name##_and(array_##name##_t* dest, const array_##name##_t* src); \
+	static void array_##name##_or(array_##name##_t* dest, const array_##name##_t* src); \
+	static void array_##name##_xor(array_##name##_t* dest, const array_##name##_t* src); \
+	static void array_##name##_andnot(array_##name##_t* dest, const array_##name##_t* src); \
+	\
+	static size_t array_##name##_popcount(const array_##name##_t* array) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(array->size); \
+		size_t count = 0; \
+		for (size_t w = 0; w < words; w++) \
+			count += _array_word_popcount(array->array[w]); \
+		return count; \
+	} \
+	\
+	static size_t array_##name##_find_first_set(const array_##name##_t* array) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(array->size); \
+		for (size_t w = 0; w < words; w++) \
+			if (array->array[w]) \
+				return w * ARRAY_H_WORD_BITS + _array_word_ctz(array->array[w]); \
+		return array->size; \
+	} \
+	\
+	static size_t array_##name##_find_first_clear(const array_##name##_t* array) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(array->size); \
+		for (size_t w = 0; w < words; w++) \
+			if (~array->array[w]) \
+			{ \
+				const size_t i = w * ARRAY_H_WORD_BITS + _array_word_ctz(~array->array[w]); \
+				return i < array->size ? i : array->size; \
+			} \
+		return array->size; \
+	} \
+	\
+	static void array_##name##_and(array_##name##_t* dest, const array_##name##_t* src) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(dest->size); \
+		const size_t srcWords = ARRAY_H_WORDS(src->size); \
+		const size_t common = words < srcWords ? words : srcWords; \
+		size_t w; \
+		for (w = 0; w < common; w++) \
+			dest->array[w] &= src->array[w]; \
+		for (; w < words; w++) \
+			dest->array[w] = 0; \
+	} \
+	\
+	static void array_##name##_or(array_##name##_t* dest, const array_##name##_t* src) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(dest->size); \
+		const size_t srcWords = ARRAY_H_WORDS(src->size); \
+		const size_t common = words < srcWords ? words : srcWords; \
+		for (size_t w = 0; w < common; w++) \
+			dest->array[w] |= src->array[w]; \
+		if (common == words && dest->size % ARRAY_H_WORD_BITS) \
+			dest->array[words - 1] &= (1ULL << (dest->size % ARRAY_H_WORD_BITS)) - 1; \
+	} \
+	\
+	static void array_##name##_xor(array_##name##_t* dest, const array_##name##_t* src) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(dest->size); \
+		const size_t srcWords = ARRAY_H_WORDS(src->size); \
+		const size_t common = words < srcWords ? words : srcWords; \
+		for (size_t w = 0; w < common; w++) \
+			dest->array[w] ^= src->array[w]; \
+		if (common == words && dest->size % ARRAY_H_WORD_BITS) \
+			dest->array[words - 1] &= (1ULL << (dest->size % ARRAY_H_WORD_BITS)) - 1; \
+	} \
+	\
+	static void array_##name##_andnot(array_##name##_t* dest, const array_##name##_t* src) \
+	{ \
+		const size_t words = ARRAY_H_WORDS(dest->size); \
+		const size_t srcWords = ARRAY_H_WORDS(src->size); \
+		const size_t common = words < srcWords ? words : srcWords; \
+		for (size_t w = 0; w < common; w++) \
+			dest->array[w] &= ~src->array[w]; \
+	}
+
+// Hash index helpers
+// Slots are probed 16 at a time, each slot has a control byte holding 7 bits of the hash or EMPTY/DELETED
+
+#define ARRAY_H_INDEX_GROUP 16
+#define ARRAY_H_INDEX_EMPTY ((uint8_t) 0x80)
+#define ARRAY_H_INDEX_DELETED ((uint8_t) 0xFE)
+
+// Spread weak hashes (e.g. identity for ints) over every bit
+static inline size_t _array_index_mix(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+	return (size_t) hash;
+}
+
+// Bit n is set if control byte n of the group equals 'byte'
+static inline uint32_t _array_index_match(const uint8_t* group, const uint8_t byte)
+{
+#ifdef ARRAY_H_INDEX_SSE2
+	const __m128i control = _mm_loadu_si128((const __m128i*) group);
+	return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char) byte)));
+#else
+	uint32_t mask = 0;
+	for (int i = 0; i < ARRAY_H_INDEX_GROUP; i++)
+		mask |= (uint32_t) (group[i] == byte) << i;
+	return mask;
+#endif
+}
+
+// Bit n is set if control byte n of the group is EMPTY or DELETED, both have the high bit set
+static inline uint32_t _array_index_match_free(const uint8_t* group)
+{
+#ifdef ARRAY_H_INDEX_SSE2
+	return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) group));
+#else
+	uint32_t mask = 0;
+	for (int i = 0; i < ARRAY_H_INDEX_GROUP; i++)
+		mask |= (uint32_t) (group[i] >> 7) << i;
+	return mask;
+#endif
+}
+
+// Smallest power of two slot count, at least one group, that keeps 'size' entries under 7/8 load
+static inline size_t _array_index_capacity_for(const size_t size)
+{
+	size_t capacity = ARRAY_H_INDEX_GROUP;
+	while (capacity / 8 * 7 <= size)
+		capacity *= 2;
+	return capacity;
+}
+
+// Hash index from 'key_field' to element position in an 'array_type_t', keys are expected to be unique
+// 'key_type' is compared with '==' & 'hash' is called as 'size_t hash(key_type key)'
+// Use the index methods instead of the array ones when changing the array, or call 'rebuild' afterward
+// 'find' returns 'array->size' when the key is not indexed
+#define ARRAY_H_DEFINE_INDEX(type, key_type, key_field, hash) \
+	typedef struct array_##type##_##key_field##_index_t \
+	{ \
+		size_t size; \
+		size_t deleted; \
+		size_t capacity; \
+		size_t* position; \
+		uint8_t* control; \
+	} array_##type##_##key_field##_index_t; \
+	\
+	static array_##type##_##key_field##_index_t* array_##type##_##key_field##_index_create(size_t capacity); \
+	static void array_##type##_##key_field##_index_delete(array_##type##_##key_field##_index_t* index); \
+	static size_t array_##type##_##key_field##_index_find(const array_##type##_##key_field##_index_t* index, const array_##type##_t* array, key_type key); \
+	static void array_##type##_##key_field##_index_rebuild(array_##type##_##key_field##_index_t** index, const array_##type##_t* array); \
+	static void array_##type##_##key_field##_index_push(array_##type##_##key_field##_index_t** index, array_##type##_t** array, type element); \
+	static type array_##type##_##key_field##_index_remove_at(array_##type##_##key_field##_index_t** index, array_##type##_t** array, size_t i); \
+	static type array_##type##_##key_field##_index_swap_remove(array_##type##_##key_field##_index_t** index, array_##type##_t** array, size_t i); \
+	static void array_##type##_##key_field##_index_adjust(array_##type##_##key_field##_index_t** index, array_##type##_t** array); \
+	static size_t _array_##type##_##key_field##_index_slot(const array_##type##_##key_field##_index_t* index, const array_##type##_t* array, key_type key, size_t h); \
+	static void _array_##type##_##key_field##_index_place(array_##type##_##key_field##_index_t* index, size_t h, size_t position); \
+	static void _array_##type##_##key_field##_index_erase(array_##type##_##key_field##_index_t* index, size_t slot); \
+	static void _array_##type##_##key_field##_index_rebuild_to(array_##type##_##key_field##_index_t** index, const array_##type##_t* array, size_t slots); \
+	\
+	static array_##type##_##key_field##_index_t* array_##type##_##key_field##_index_create(const size_t capacity) \
+	{ \
+		const size_t slots = _array_index_capacity_for(capacity); \
+		array_##type##_##key_field##_index_t* index = malloc(sizeof(array_##type##_##key_field##_index_t) + slots * (sizeof(size_t) + 1)); \
+		if (index == NULL) \
+		{ \
+			fprintf(stderr, "Out of memory! Failed to allocate index!\n"); \
+			exit(EXIT_FAILURE); \
+		} \
+		index->size = index->deleted = 0; \
+		index->capacity = slots; \
+		index->position = (size_t*) (index + 1); \
+		index->control = (uint8_t*) (index->position + slots); \
+		memset(index->control, ARRAY_H_INDEX_EMPTY, slots); \
+		return index; \
+	} \
+	\
+	static void array_##type##_##key_field##_index_delete(array_##type##_##key_field##_index_t* index) \
+	{ \
+		index->position = NULL; \
+		index->control = NULL; \
+		index->size = index->capacity = 0; \
+		free(index); \
+	} \
+	\
+	/* Returns the slot holding 'key' or 'index->capacity' */ \
+	static size_t _array_##type##_##key_field##_index_slot(const array_##type##_##key_field##_index_t* index, const array_##type##_t* array, const key_type key, const size_t h) \
+	{ \
+		const size_t groupMask = index->capacity / ARRAY_H_INDEX_GROUP - 1; \
+		const uint8_t tag = (uint8_t) (h & 0x7F); \
+		size_t group = (h >> 7) & groupMask; \
+		for (size_t probe = 1; probe <= groupMask + 1; probe++) \
+		{ \
+			const uint8_t* control = index->control + group * ARRAY_H_INDEX_GROUP; \
+			uint32_t match = _array_index_match(control, tag); \
+			while (match) \
+			{ \
+				const size_t slot = group * ARRAY_H_INDEX_GROUP + _array_word_ctz(match); \
+				if (array->array[index->position[slot]].key_field == key) \
+					return slot; \
+				match &= match - 1; \
+			} \
+			if (_array_index_match(control, ARRAY_H_INDEX_EMPTY)) \
+				break; \
+			group = (group + probe) & groupMask; \
+		} \
+		return index->capacity; \
+	} \
+	\
+	static size_t array_##type##_##key_field##_index_find(const array_##type##_##key_field##_index_t* index, const array_##type##_t* array, const key_type key) \
+	{ \
+		const size_t slot = _array_##type##_##key_field##_index_slot(index, array, key, _array_index_mix(hash(key))); \
+		return slot < index->capacity ? index->position[slot] : array->size; \
+	} \
+	\
+	/* Places 'position' in the first free slot, the key must not already be indexed */ \
+	static void _array_##type##_##key_field##_index_place(array_##type##_##key_field##_index_t* index, const size_t h, const size_t position) \
+	{ \
+		const size_t groupMask = index->capacity / ARRAY_H_INDEX_GROUP - 1; \
+		size_t group = (h >> 7) & groupMask; \
+		for (size_t probe = 1;; probe++) \
+		{ \
+			const uint32_t available = _array_index_match_free(index->control + group * ARRAY_H_INDEX_GROUP); \
+			if (available) \
+			{ \
+				const size_t slot = group * ARRAY_H_INDEX_GROUP + _array_word_ctz(available); \
+				if (index->control[slot] == ARRAY_H_INDEX_DELETED) \
+					index->deleted--; \
+				index->control[slot] = (uint8_t) (h & 0x7F); \
+				index->position[slot] = position; \
+				index->size++; \
+				return; \
+			} \
+			group = (group + probe) & groupMask; \
+		} \
+	} \
+	\
+	static void _array_##type##_##key_field##_index_erase(array_##type##_##key_field##_index_t* index, const size_t slot) \
+	{ \
+		/* Probing stops at a group with an EMPTY slot, so if this group has one nothing probes past it */ \
+		const uint8_t* control = index->control + slot / ARRAY_H_INDEX_GROUP * ARRAY_H_INDEX_GROUP; \
+		if (_array_index_match(control, ARRAY_H_INDEX_EMPTY)) \
+			index->control[slot] = ARRAY_H_INDEX_EMPTY; \
+		else \
+		{ \
+			index->control[slot] = ARRAY_H_INDEX_DELETED; \
+			index->deleted++; \
+		} \
+		index->size--; \
+	} \
+	\
+	/* Resizes the table to 'slots' & places every element without key comparisons, faster than pushing one at a time */ \
+	static void _array_##type##_##key_field##_index_rebuild_to(array_##type##_##key_field##_index_t** index, const array_##type##_t* array, const size_t slots) \
+	{ \
+		if (slots != (*index)->capacity) \
+		{ \
+			array_##type##_##key_field##_index_t* newIndex = realloc(*index, sizeof(array_##type##_##key_field##_index_t) + slots * (sizeof(size_t) + 1)); \
+			if (newIndex == NULL) \
+			{ \
+				fprintf(stderr, "Out of memory! Failed to reallocate index!\n"); \
+				array_##type##_##key_field##_index_delete(*index); \
+				exit(EXIT_FAILURE); \
+			} \
+			*index = newIndex; \
+			(*index)->capacity = slots; \
+			(*index)->position = (size_t*) (*index + 1); \
+			(*index)->control = (uint8_t*) ((*index)->position + slots); \
+		} \
+		(*index)->size = (*index)->deleted = 0; \
+		memset((*index)->control, ARRAY_H_INDEX_EMPTY, slots); \
+		for (size_t i = 0; i < array->size; i++) \
+			_array_##type##_##key_field##_index_place(*index, _array_index_mix(hash(array->array[i].key_field)), i); \
+	} \
+	\
+	static void array_##type##_##key_field##_index_rebuild(array_##type##_##key_field##_index_t** index, const array_##type##_t* array) \
+	{ \
+		_array_##type##_##key_field##_index_rebuild_to(index, array, _array_index_capacity_for(array->size)); \
+	} \
+	\
+	/* Pushing a key that is already indexed points the index at the new element */ \
+	static void array_##type##_##key_field##_index_push(array_##type##_##key_field##_index_t** index, array_##type##_t** array, const type element) \
+	{ \
+		array_##type##_push(array, element); \
+		const size_t position = (*array)->size - 1; \
+		const size_t h = _array_index_mix(hash(element.key_field)); \
+		const size_t slot = _array_##type##_##key_field##_index_slot(*index, *array, element.key_field, h); \
+		if (slot < (*index)->capacity) \
+			(*index)->position[slot] = position; \
+		else if ((*index)->size + (*index)->deleted >= (*index)->capacity / 8 * 7) \
+		{ \
+			/* Over 3/4 live doubles, otherwise tombstones are at least 1/8 of the slots & purging them in place */ \
+			/* frees enough room that the next rebuild is that many pushes away */ \
+			const size_t capacity = (*index)->capacity; \
+			const size_t slots = (*index)->size >= capacity / 4 * 3 ? capacity * 2 : capacity; \
+			_array_##type##_##key_field##_index_rebuild_to(index, *array, slots); \
+		} \
+		else \
+			_array_##type##_##key_field##_index_place(*index, h, position); \
+	} \
+	\
+	static type array_##type##_##key_field##_index_remove_at(array_##type##_##key_field##_index_t** index, array_##type##_t** array, const size_t i) \
+	{ \
+		const key_type key = (*array)->array[i].key_field; \
+		const size_t slot = _array_##type##_##key_field##_index_slot(*index, *array, key, _array_index_mix(hash(key))); \
+		if (slot < (*index)->capacity && (*index)->position[slot] == i) \
+			_array_##type##_##key_field##_index_erase(*index, slot); \
+		/* Everything after 'i' moves down by 1 */ \
+		for (size_t s = 0; s < (*index)->capacity; s++) \
+			if (!((*index)->control[s] & 0x80) && (*index)->position[s] > i) \
+				(*index)->position[s]--; \
+		return array_##type##_remove_at(array, i); \
+	} \
+	\
+	static type array_##type##_##key_field##_index_swap_remove(array_##type##_##key_field##_index_t** index, array_##type##_t** array, const size_t i) \
+	{ \
+		const size_t last = (*array)->size - 1; \
+		const key_type key = (*array)->array[i].key_field; \
+		size_t slot = _array_##type##_##key_field##_index_slot(*index, *array, key, _array_index_mix(hash(key))); \
+		if (slot < (*index)->capacity && (*index)->position[slot] == i) \
+			_array_##type##_##key_field##_index_erase(*index, slot); \
+		if (i < last) \
+		{ \
+			const key_type lastKey = (*array)->array[last].key_field; \
+			slot = _array_##type##_##key_field##_index_slot(*index, *array, lastKey, _array_index_mix(hash(lastKey))); \
+			if (slot < (*index)->capacity && (*index)->position[slot] == last) \
+				(*index)->position[slot] = i; \
+		} \
+		return array_##type##_swap_remove(array, i); \
+	} \
+	\
+	/* Positions don't change when the array is reallocated, only shrink the index if it's mostly empty */ \
+	static void array_##type##_##key_field##_index_adjust(array_##type##_##key_field##_index_t** index, array_##type##_t** array) \
+	{ \
+		array_##type##_adjust(array); \
+		if (_array_index_capacity_for((*array)->size) * 4 <= (*index)->capacity) \
+			array_##type##_##key_field##_index_rebuild(index, *array); \
+	}
+
+// Heap helpers
+
+#define ARRAY_H_HEAP_NONE ((size_t) -1)
+
+// Grow a 'size_t' buffer to hold at least 'needed' entries
+static inline void _array_heap_reserve(size_t** data, size_t* capacity, const size_t needed)
+{
+	if (needed <= *capacity)
+		return;
+	size_t newCapacity = *capacity ? *capacity : 2;
+	while (newCapacity < needed)
+		newCapacity *= 2;
+	size_t* newData = realloc(*data, newCapacity * sizeof(size_t));
+	if (newData == NULL)
+	{
+		fprintf(stderr, "Out of memory! Failed to reallocate heap!\n");
+		exit(EXIT_FAILURE);
+	}
+	*data = newData;
+	*capacity = newCapacity;
+}
+
+// Min heap stored in an 'array_type_t', 'less' is called as 'int less(type a, type b)'
+// 'arity' children per node, siblings sit next to each other so 4 or 8 scan them in one pass & halve/third the depth
+// 'push' returns a handle that stays valid until that element is popped, pass it to 'decrease_key'
+// 'ARRAY_H_DEFINE_HEAP' makes 'array_type_heap_t', 'ARRAY_H_DEFINE_HEAP_ARITY' puts the arity in the name, e.g. 'array_type_heap4_t'
+// so one type can have heaps of different arity, 'arity' has to be a plain number
+#define ARRAY_H_DEFINE_HEAP(type, less) _ARRAY_H_DEFINE_HEAP(type, array_##type##_heap, less, 2)
+#define ARRAY_H_DEFINE_HEAP_ARITY(type, less, arity) _ARRAY_H_DEFINE_HEAP(type, array_##type##_heap##arity, less, arity)
+
+#define _ARRAY_H_DEFINE_HEAP(type, name, less, arity) \
+	_Static_assert((arity) >= 2, "Heap arity must be at least 2"); \
+	\
+	typedef struct name##_t \
+	{ \
+		array_##type##_t* array; \
+		size_t* handle; \
+		size_t handleCapacity; \
+		size_t* position; \
+		size_t positionCapacity; \
+		size_t handleCount; \
+		size_t handleFree; \
+	} name##_t; \
+	\
+	static name##_t* name##_create(size_t capacity); \
+	static name##_t* name##_heapify(array_##type##_t* array); \
+	static void name##_delete(name##_t* heap); \
+	static size_t name##_push(name##_t* heap, type element); \
+	static type name##_peek(const name##_t* heap); \
+	static type name##_pop(name##_t* heap); \
+	static void name##_decrease_key(name##_t* heap, size_t handle, type element); \
+	static void _##name##_sift_up(name##_t* heap, size_t i, type element, size_t handle); \
+	static void _##name##_sift_down(name##_t* heap, size_t i, type element, size_t handle); \
+	\
+	static name##_t* name##_create(const size_t capacity) \
+	{ \
+		return name##_heapify(array_##type##_create(capacity)); \
+	} \
+	\
+	/* Takes over 'array' & orders it in O(N), element i gets handle i */ \
+	static name##_t* name##_heapify(array_##type##_t* array) \
+	{ \
+		name##_t* heap = malloc(sizeof(name##_t)); \
+		if (heap == NULL) \
+		{ \
+			fprintf(stderr, "Out of memory! Failed to allocate heap!\n"); \
+			exit(EXIT_FAILURE); \
+		} \
+		heap->array = array; \
+		heap->handle = heap->position = NULL; \
+		heap->handleCapacity = heap->positionCapacity = 0; \
+		heap->handleCount = array->size; \
+		heap->handleFree = ARRAY_H_HEAP_NONE; \
+		_array_heap_reserve(&heap->handle, &heap->handleCapacity, array->capacity); \
+		_array_heap_reserve(&heap->position, &heap->positionCapacity, array->size); \
+		for (size_t i = 0; i < array->size; i++) \
+			heap->handle[i] = heap->position[i] = i; \
+		if (array->size > 1) \
+			for (size_t i = (array->size - 2) / (arity) + 1; i-- > 0;) \
+				_##name##_sift_down(heap, i, array->array[i], heap->handle[i]); \
+		return heap; \
+	} \
+	\
+	static void name##_delete(name##_t* heap) \
+	{ \
+		array_##type##_delete(heap->array); \
+		free(heap->handle); \
+		free(heap->position); \
+		free(heap); \
+	} \
+	\
+	/* Moves the hole at 'i' up until 'element' fits, then fills it */ \
+	static void _##name##_sift_up(name##_t* heap, size_t i, const type element, const size_t handle) \
+	{ \
+		type* array = heap->array->array; \
+		while (i > 0) \
+		{ \
+			const size_t parent = (i - 1) / (arity); \
+			if (!less(element, array[parent])) \
+				break; \
+			array[i] = array[parent]; \
+			heap->handle[i] = heap->handle[parent]; \
+			heap->position[heap->handle[i]] = i; \
+			i = parent; \
+		} \
+		array[i] = element; \
+		heap->handle[i] = handle; \
+		heap->position[handle] = i; \
+	} \
+	\
+	/* Moves the hole at 'i' down until 'element' fits, then fills it */ \
+	static void _##name##_sift_down(name##_t* heap, size_t i, const type element, const size_t handle) \
+	{ \
+		type* array = heap->array->array; \
+		const size_t size = heap->array->size; \
+		for (;;) \
+		{ \
+			const size_t first = i * (arity) + 1; \
+			if (first >= size) \
+				break; \
+			const size_t last = size - first < (arity) ? size : first + (arity); \
+			size_t best = first; \
+			for (size_t c = first + 1; c < last; c++) \
+				if (less(array[c], array[best])) \
+					best = c; \
+			if (!less(array[best], element)) \
+				break; \
+			array[i] = array[best]; \
+			heap->handle[i] = heap->handle[best]; \
+			heap->position[heap->handle[i]] = i; \
+			i = best; \
+		} \
+		array[i] = element; \
+		heap->handle[i] = handle; \
+		heap->position[handle] = i; \
+	} \
+	\
+	static size_t name##_push(name##_t* heap, const type element) \
+	{ \
+		array_##type##_push(&heap->array, element); \
+		_array_heap_reserve(&heap->handle, &heap->handleCapacity, heap->array->capacity); \
+		size_t handle = heap->handleFree; \
+		if (handle != ARRAY_H_HEAP_NONE) \
+			heap->handleFree = heap->position[handle]; \
+		else \
+		{ \
+			handle = heap->handleCount++; \
+			_array_heap_reserve(&heap->position, &heap->positionCapacity, heap->handleCount); \
+		} \
+		_##name##_sift_up(heap, heap->array->size - 1, element, handle); \
+		return handle; \
+	} \
+	\
+	static type name##_peek(const name##_t* heap) \
+	{ \
+		return heap->array->array[0]; \
+	} \
+	\
+	static type name##_pop(name##_t* heap) \
+	{ \
+		const type top = heap->array->array[0]; \
+		/* Popped handles are chained through 'position' for reuse */ \
+		const size_t handle = heap->handle[0]; \
+		heap->position[handle] = heap->handleFree; \
+		heap->handleFree = handle; \
+		const size_t lastHandle = heap->handle[heap->array->size - 1]; \
+		const type last = array_##type##_remove_at(&heap->array, heap->array->size - 1); \
+		if (heap->array->size > 0) \
+			_##name##_sift_down(heap, 0, last, lastHandle); \
+		return top; \
+	} \
+	\
+	/* 'element' must not be greater than the one it replaces */ \
+	static void name##_decrease_key(name##_t* heap, const size_t handle, const type element) \
+	{ \
+		_##name##_sift_up(heap, heap->position[handle], element, handle); \
+	}
+
 // ARRAY_H_DEFINE_ARRAY(int) // array_int_t
 // ARRAY_H_DEFINE_ARRAY(float) // array_float_t
 // ARRAY_H_DEFINE_ARRAY(double) // array_double_t
@@ -171,4 +910,29 @@
 // array_int_remove_at(&array_int, 0);				// size=2 capacity=4
 // array_int_adjust(&array_int);					// size=2 capacity=2
 
+// An index keeps a key -> position table in sync with the array, change the array through the index methods
+// size_t car_id_hash(int id) { return id; }
+// ARRAY_H_DEFINE_INDEX(car_t, int, id, car_id_hash) // array_car_t_id_index_t
+// array_car_t_id_index_t* index = array_car_t_id_index_create(0);
+// array_car_t_id_index_push(&index, &cars, car);
+// size_t i = array_car_t_id_index_find(index, cars, 42);	// 'cars->size' if not found
+// array_car_t_id_index_swap_remove(&index, &cars, i);
+
+// A heap takes over an array & keeps the smallest element (by 'less') at index 0
+// int timer_less(timer_t a, timer_t b) { return a.deadline < b.deadline; }
+// ARRAY_H_DEFINE_HEAP_ARITY(timer_t, timer_less, 4) // array_timer_t_heap4_t, 4 children per node
+// array_timer_t_heap4_t* heap = array_timer_t_heap4_heapify(timers);	// O(N), 'timers' is owned by the heap now
+// size_t handle = array_timer_t_heap4_push(heap, timer);
+// array_timer_t_heap4_decrease_key(heap, handle, sooner);
+// timer_t next = array_timer_t_heap4_pop(heap);
+
+// Packed arrays store unsigned values 'bits' wide, values are masked on push/set
+// ARRAY_H_DEFINE_PACKED(u4, 4) // array_u4_t, 16 elements per 64-bit word
+// ARRAY_H_DEFINE_BITARRAY(bit) // array_bit_t, 64 elements per 64-bit word
+// array_bit_t* a = array_bit_create(128);
+// array_bit_t* b = array_bit_create(128);
+// ...push...
+// array_bit_and(a, b);								// a &= b, a word at a time
+// size_t n = array_bit_popcount(a);
+
 #endif /* ARRAY_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Lazy map/filter/reduce pipelines for both array flavors
+ * Stages are statements inside an 'ARRAY_PIPE' block, they all run in one loop with no intermediate arrays
+ *
+ * Created by Duncan on 19/10/2026.
+ *
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ * Full license can be found in the LICENSE file
+ *
+ * Changelog 1.0:
+ *	- Initial code
+ *
+ * Changelog 1.1:
+ *	- Added 'ARRAY_PIPE_SLICE' for 'ArraySlice' views
+ *
+ * Changelog 1.2:
+ *	- Skip/take stages check they fit in 'ARRAY_PIPE_MAX_STAGES', exits if not
+ */
+
+#ifndef ARRAY_PIPE_H_
+#define ARRAY_PIPE_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Max number of 'ARRAY_PIPE_SKIP' & 'ARRAY_PIPE_TAKE' stages in one pipeline, more exits the program
+// Define 'ARRAY_PIPE_MAX_STAGES' before including this header for more
+#ifndef ARRAY_PIPE_MAX_STAGES
+#define ARRAY_PIPE_MAX_STAGES 8
+#endif
+
+static inline size_t* _array_pipe_overflow(void)
+{
+	fprintf(stderr, "Too many skip/take stages in pipeline! Raise 'ARRAY_PIPE_MAX_STAGES'!\n");
+	exit(EXIT_FAILURE);
+}
+
+// Next skip/take counter, checked in every build type
+// '_pipeStage' is the same every element so the compiler folds the check away for valid pipelines
+#define _ARRAY_PIPE_COUNTER (*(_pipeStage < ARRAY_PIPE_MAX_STAGES ? &_pipeSeen[_pipeStage++] : _array_pipe_overflow()))
+
+// Loops 'name' over 'length' elements of 'data', follow with a block of stages
+// 'c_array_define.h' arrays: ARRAY_PIPE(int, v, array->array, array->size)
+// 'c_array.h' arrays: ARRAY_PIPE(int, v, array, arrayGetLength(array))
+// 'c_array.h' arrays that may be migrating (see 'arraySetMigrationStep') need 'arrayMigrateFinish' first
+// or loop over 'arraySliceAll(array)' with 'ARRAY_PIPE_SLICE', which finishes it for you
+// The inner loop only runs once per element, it gives 'name' a scope so 'continue' & 'break' skip the element
+// Skip/take state is voided in the condition so pipelines without those stages don't warn
+#define ARRAY_PIPE(type, name, data, length) _ARRAY_PIPE_LOOP(type, name, (data)[_pipeI], length)
+
+// Loops 'name' over an 'ArraySlice' from 'c_array.h', e.g. ARRAY_PIPE_SLICE(float, speed, arraySliceField(cars, speed))
+// 'slice' is evaluated once, the outer loop only runs once to bind it
+#define ARRAY_PIPE_SLICE(type, name, slice) \
+	for (ArraySlice _pipeSlice = (slice), *_pipeSliceOnce = &_pipeSlice; _pipeSliceOnce; _pipeSliceOnce = NULL) \
+		_ARRAY_PIPE_LOOP(type, name, *(const type*) ((const char*) _pipeSlice.data + _pipeI * _pipeSlice.stride), _pipeSlice.length)
+
+#define _ARRAY_PIPE_LOOP(type, name, element, length) \
+	for (size_t _pipeSeen[ARRAY_PIPE_MAX_STAGES] = {0}, _pipeStage = 0, _pipeOnce = 1, _pipeI = 0, _pipeLength = (length); \
+		(void) _pipeSeen, (void) _pipeStage, _pipeI < _pipeLength; \
+		_pipeI++, _pipeStage = 0, _pipeOnce = 1) \
+		for (type name = element; _pipeOnce; _pipeOnce = 0)
+
+// Drop elements where 'condition' is false
+#define ARRAY_PIPE_FILTER(condition) if (!(condition)) continue
+
+// Declare 'name' as 'expression' for the following stages
+#define ARRAY_PIPE_MAP(type, name, expression) type name = (expression)
+
+// Drop the first 'n' elements that reach this stage
+// Counts against 'ARRAY_PIPE_MAX_STAGES'
+#define ARRAY_PIPE_SKIP(n) if (_ARRAY_PIPE_COUNTER++ < (size_t) (n)) continue
+
+// Let 'n' elements past this stage, the whole pipeline stops when the next one arrives
+// Counts against 'ARRAY_PIPE_MAX_STAGES'
+#define ARRAY_PIPE_TAKE(n) if (_ARRAY_PIPE_COUNTER++ >= (size_t) (n) && (_pipeI = _pipeLength)) break
+
+// Reduce into 'accumulator', which has to be declared & initialised before the pipeline
+// e.g. int sum = 0; ... ARRAY_PIPE_FOLD(sum, sum + v);
+#define ARRAY_PIPE_FOLD(accumulator, expression) (accumulator) = (expression)
+
+// Append to a 'c_array_define.h' array, create 'dest' with enough capacity to never reallocate
+#define ARRAY_PIPE_SINK(type, dest, value) array_##type##_push(&(dest), (value))
+
+// Append to a 'c_array.h' array, use 'arrayCreatePrealloc' for 'dest' to never reallocate
+#define ARRAY_PIPE_SINK_NEW(type, dest, value) ((dest) = _arrayPushAt(dest, _arrayFieldGet(dest, LENGTH), &(type){ (value) }))
+
+// int sum = 0;
+// array_int_t* evens = array_int_create(array->size);
+// ARRAY_PIPE(int, v, array->array, array->size)
+// {
+// 	ARRAY_PIPE_FILTER(v % 2 == 0);
+// 	ARRAY_PIPE_MAP(long, squared, (long) v * v);
+// 	ARRAY_PIPE_SKIP(1);
+// 	ARRAY_PIPE_TAKE(10);
+// 	ARRAY_PIPE_SINK(int, evens, v);
+// 	ARRAY_PIPE_FOLD(sum, sum + squared);
+// }
+
+#endif /* ARRAY_PIPE_H_ */
@@ -9,8 +9,26 @@
 
 #include "c_array_define.h"
 #include "c_array.h"
+#include "c_array_pipe.h"
 
 ARRAY_H_DEFINE_ARRAY(int)
+ARRAY_H_DEFINE_BITARRAY(bit)
+ARRAY_H_DEFINE_PACKED(u12, 12)
+
+typedef struct car_t
+{
+	int id;
+	float speed;
+} car_t;
+size_t car_id_hash(const int id) { return (size_t) id; }
+ARRAY_H_DEFINE_ARRAY(car_t)
+ARRAY_H_DEFINE_INDEX(car_t, int, id, car_id_hash)
+
+typedef uint64_t deadline_t;
+int deadline_less(const uint64_t a, const uint64_t b) { return a < b; }
+ARRAY_H_DEFINE_ARRAY(deadline_t)
+ARRAY_H_DEFINE_HEAP(deadline_t, deadline_less)
+ARRAY_H_DEFINE_HEAP_ARITY(deadline_t, deadline_less, 4)
 
 void printArrayNewDetails(void* array);
 void printArrayIntTDetails(const array_int_t* array);
@@ -23,6 +41,12 @@ void testArrayIntTAvg(uint64_t times, bool debugOut);
 
 void testArrayNewStruct();
 void testArrayNew();
+void testArrayPacked();
+void testArrayIndex();
+void testArrayPipe();
+void testArrayAdopt();
+void testArrayResizeLatency(uint64_t pushes, size_t step);
+void testArrayHeap(size_t timers);
 
 int main()
 {
@@ -40,6 +64,16 @@ int main()
 
 	testArrayNewStruct();
 	// testArrayNew();
+	// testArrayPacked();
+	// testArrayIndex();
+	// testArrayPipe();
+	// testArrayAdopt();
+
+	// const uint64_t pushes = 1 << 22;
+	// testArrayResizeLatency(pushes, 0);
+	// testArrayResizeLatency(pushes, 64);
+
+	// testArrayHeap(1000000);
 
 	// array_test_1d_int();
 	// array_test_2d_int();
@@ -95,6 +129,12 @@ int compare(const void* a, const void* b)
 	return *(int*)a - *(int*)b;
 }
 
+int compareU64(const void* a, const void* b)
+{
+	const uint64_t x = *(uint64_t*)a, y = *(uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
 static void array_int_shift_left(array_int_t** array, size_t shift)
 {
 	if (shift <= 0 || (*array)->size <= 0)
@@ -384,3 +424,224 @@ void testArrayNew()
 
 	arrayDestroy(array);
 }
+
+void testArrayPacked()
+{
+	array_bit_t* evens = array_bit_create(64);
+	array_bit_t* thirds = array_bit_create(64);
+	array_u12_t* values = array_u12_create(8);
+
+	int i;
+	for (i = 0; i < 100; i++)
+	{
+		array_bit_push(&evens, i % 2 == 0);
+		array_bit_push(&thirds, i % 3 == 0);
+		array_u12_push(&values, i * 41); // Masked to 12 bits
+	}
+
+	printf("Evens: %zu, thirds: %zu\n", array_bit_popcount(evens), array_bit_popcount(thirds));
+	array_bit_and(evens, thirds);
+	printf("Evens & thirds: %zu, first set: %zu, first clear: %zu\n",
+		array_bit_popcount(evens),
+		array_bit_find_first_set(evens),
+		array_bit_find_first_clear(evens));
+
+	printf("Removed: %u\n", array_u12_remove_at(&values, 0));
+	for (i = 0; i < 10; i++)
+		printf("%u ", array_u12_get(values, i));
+	printf("\n");
+
+	array_u12_adjust(&values);
+	printf("u12 size: %zu, capacity: %zu, bytes: %zu\n",
+		values->size,
+		values->capacity,
+		ARRAY_H_WORDS(values->capacity * 12) * sizeof(uint64_t));
+
+	array_bit_delete(evens);
+	array_bit_delete(thirds);
+	array_u12_delete(values);
+}
+
+void testArrayIndex()
+{
+	array_car_t_t* cars = array_car_t_create(4);
+	array_car_t_id_index_t* index = array_car_t_id_index_create(4);
+
+	int i;
+	for (i = 0; i < 1000; i++)
+	{
+		const car_t car = { i * 7, (float) i / 10.f };
+		array_car_t_id_index_push(&index, &cars, car);
+	}
+
+	printf("Find id 70: %zu\n", array_car_t_id_index_find(index, cars, 70));
+	array_car_t_id_index_remove_at(&index, &cars, 0);
+	printf("Remove at 0, find id 70: %zu\n", array_car_t_id_index_find(index, cars, 70));
+	array_car_t_id_index_swap_remove(&index, &cars, 0);
+	printf("Swap remove 0, find id %d: %zu\n", 999 * 7, array_car_t_id_index_find(index, cars, 999 * 7));
+	printf("Find missing id 1: %zu (size %zu)\n", array_car_t_id_index_find(index, cars, 1), cars->size);
+
+	array_car_t_id_index_rebuild(&index, cars);
+	printf("Rebuilt index, size: %zu, capacity: %zu\n", index->size, index->capacity);
+
+	array_car_t_id_index_delete(index);
+	array_car_t_delete(cars);
+}
+
+void testArrayPipe()
+{
+	array_int_t* array_int = array_int_create(100);
+	int* array = arrayCreatePrealloc(int, 100, 10);
+
+	int i;
+	for (i = 0; i < 100; i++)
+	{
+		array_int_push(&array_int, i);
+		arrayPushBack(array, i);
+	}
+
+	// filter -> map -> sum in one pass, no temporary arrays
+	long sum = 0;
+	array_int_t* odds = array_int_create(50);
+	ARRAY_PIPE(int, v, array_int->array, array_int->size)
+	{
+		ARRAY_PIPE_FILTER(v % 2 == 1);
+		ARRAY_PIPE_SINK(int, odds, v);
+		ARRAY_PIPE_MAP(long, squared, (long) v * v);
+		ARRAY_PIPE_FOLD(sum, sum + squared);
+	}
+	printf("Odd count: %zu, sum of odd squares: %ld\n", odds->size, sum);
+
+	int* tens = arrayCreatePrealloc(int, 5, 5);
+	ARRAY_PIPE(int, v, array, arrayGetLength(array))
+	{
+		ARRAY_PIPE_FILTER(v % 10 == 0);
+		ARRAY_PIPE_SKIP(1);
+		ARRAY_PIPE_TAKE(5);
+		ARRAY_PIPE_SINK_NEW(int, tens, v);
+	}
+	for (i = 0; i < arrayGetLength(tens); i++)
+		printf("%d ", tens[i]);
+	printf("\n");
+	printArrayNewDetails(tens);
+
+	array_int_delete(odds);
+	array_int_delete(array_int);
+	arrayDestroy(tens);
+	arrayDestroy(array);
+}
+
+void testArrayAdopt()
+{
+	// Pretend this was filled by a parser
+	int* buffer = arrayBufferAlloc(int, 16);
+	int i;
+	for (i = 0; i < 10; i++)
+		buffer[i] = i * i;
+
+	int* array = arrayAdopt(int, buffer, 10, 16);
+	printArrayNewDetails(array);
+
+	const int n = -1;
+	arrayPushBack(array, n);
+
+	const ArraySlice slice = arraySlice(array, 2, 4);
+	for (i = 0; i < slice.length; i++)
+		printf("%d ", arraySliceGet(int, slice, i));
+	printf("\n");
+
+	int sum = 0;
+	ARRAY_PIPE_SLICE(int, v, slice)
+		ARRAY_PIPE_FOLD(sum, sum + v);
+	printf("Slice sum: %d\n", sum);
+
+	size_t length;
+	int* released = arrayRelease(array, &length);
+	printf("Released %zu elements, last: %d\n", length, released[length - 1]);
+	arrayBufferFree(released);
+}
+
+void testArrayResizeLatency(const uint64_t pushes, const size_t step)
+{
+	// Large increment so there are only a few resizes, each one copying a lot
+	long* array = arrayCreatePrealloc(long, 1024, pushes / 16);
+	arraySetMigrationStep(array, step);
+	uint64_t* latencies = arrayCreatePrealloc(uint64_t, pushes, 1);
+
+	for (uint64_t i = 0; i < pushes; i++)
+	{
+		struct timespec start, end;
+		const long n = (long) i;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		arrayPushBack(array, n);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		const uint64_t time = (end.tv_sec - start.tv_sec) * 1000000000 + (end.tv_nsec - start.tv_nsec);
+		arrayPushBack(latencies, time);
+	}
+
+	qsort(latencies, pushes, sizeof(uint64_t), compareU64);
+	printf("Push latency step %zu (%llu): p50 %lluns, p99 %lluns, p99.9 %lluns, p99.99 %lluns, max %lluns\n",
+		step,
+		pushes,
+		latencies[pushes / 2],
+		latencies[pushes * 99 / 100],
+		latencies[pushes * 999 / 1000],
+		latencies[pushes * 9999 / 10000],
+		latencies[pushes - 1]);
+
+	arrayDestroy(latencies);
+	arrayDestroy(array);
+}
+
+void testArrayHeap(const size_t timers)
+{
+	srand(1);
+	array_deadline_t_t* deadlines = array_deadline_t_create(timers);
+	array_deadline_t_t* deadlines4 = array_deadline_t_create(timers);
+	size_t i;
+	for (i = 0; i < timers; i++)
+	{
+		const uint64_t deadline = (uint64_t) rand() * RAND_MAX + rand();
+		array_deadline_t_push(&deadlines, deadline);
+		array_deadline_t_push(&deadlines4, deadline);
+	}
+
+	struct timespec start, end;
+	uint64_t time;
+	bool sorted = true;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	array_deadline_t_heap_t* heap = array_deadline_t_heap_heapify(deadlines);
+	// Move the first 100 timers sooner through their handles
+	for (i = 0; i < 100; i++)
+		array_deadline_t_heap_decrease_key(heap, i, 0);
+	uint64_t previous = 0;
+	while (heap->array->size > 0)
+	{
+		const uint64_t next = array_deadline_t_heap_pop(heap);
+		sorted &= next >= previous;
+		previous = next;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	time = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+	printf("Binary heap heapify & pop %zu: %lluus\n", timers, time);
+	array_deadline_t_heap_delete(heap);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	array_deadline_t_heap4_t* heap4 = array_deadline_t_heap4_heapify(deadlines4);
+	for (i = 0; i < 100; i++)
+		array_deadline_t_heap4_decrease_key(heap4, i, 0);
+	previous = 0;
+	while (heap4->array->size > 0)
+	{
+		const uint64_t next = array_deadline_t_heap4_pop(heap4);
+		sorted &= next >= previous;
+		previous = next;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	time = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+	printf("4-ary heap heapify & pop %zu: %lluus\n", timers, time);
+	array_deadline_t_heap4_delete(heap4);
+
+	printf("Popped in order: %s\n", sorted ? "yes" : "no");
+}